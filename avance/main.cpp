@@ -10,6 +10,8 @@
   *    aplicados a una versión transformada de la imagen, en forma de tripletas RGB.
   * 5. Muestra en consola los valores cargados desde el archivo de enmascaramiento.
   * 6. Gestiona la memoria dinámicamente, liberando los recursos utilizados.
+  * 7. Reconstruye la cadena de operaciones a nivel de bit mediante una búsqueda de encuentro a mitad
+  *    de camino (desde la imagen inicial y desde la final), verificada contra cada archivo Mk.txt.
   *
   * Entradas:
   * - Archivo de imagen BMP de entrada ("I_O.bmp").
@@ -52,6 +54,46 @@ unsigned char* rotateImage(unsigned char* img, int width, int height, int bits,
 void enmascararYGuardar(unsigned char* imgTransformada, int imgWidth, int imgHeight,
                         unsigned char* mask, int maskWidth, int maskHeight, int s,
                         const string& filename);
+bool coincideConEnmascaramiento(unsigned char* datos, unsigned char* mask, unsigned int* valores, int longitud);
+void aplicarOperacionBytes(unsigned char* origen, unsigned char* destino, unsigned char* aleatoria,
+                           int longitud, int op, bool inversa);
+unsigned char* aplicarOperacion(unsigned char* img, unsigned char* imgAleatoria, int width, int height, int op);
+void describirOperacion(int op);
+unsigned long long huellaVentana(unsigned char* img, int inicio, int longitud);
+unsigned char* extraerVentana(unsigned char* img, int* inicios, int numBloques, int longitudBloque);
+int buscarEnTabla(int* tabla, int capacidad, unsigned char* ventanas, unsigned long long* huellas,
+                  int longitudVentana, unsigned char* ventana, unsigned long long huella);
+bool reservarNivel(long long maxEstados, long long maxCodigos, int longitudVentana,
+                   unsigned char*& ventanas, unsigned long long*& huellas, int*& primerCodigo,
+                   int*& codigos, int*& siguienteCodigo, int*& tabla, int& capacidad);
+void liberarNivel(unsigned char* ventanas, unsigned long long* huellas, int* primerCodigo,
+                  int* codigos, int* siguienteCodigo, int* tabla);
+int expandirNivel(unsigned char* ventanas, int* primerCodigo, int* codigos, int* siguienteCodigo, int numEstados,
+                  unsigned char* ventanaAleatoria, int longitudVentana, bool inversa,
+                  unsigned char* mask, unsigned int* valoresPaso, int inicioBloque, int longitudBloque,
+                  unsigned char* nuevasVentanas, unsigned long long* nuevasHuellas, int* nuevoPrimerCodigo,
+                  int* nuevosCodigos, int* nuevoSiguienteCodigo, int& numNuevosCodigos,
+                  int* tabla, int capacidad);
+bool verificarCadena(unsigned char* imgInicial, unsigned char* imgFinal, unsigned char* imgAleatoria,
+                     int width, int height, unsigned char* mask, int maskDataSize,
+                     int* semillas, unsigned int* valores, int numArchivos,
+                     int* cadena, int numOperaciones);
+bool buscarEncuentroEnMedio(unsigned char* imgInicial, unsigned char* imgFinal, unsigned char* imgAleatoria,
+                            int width, int height, unsigned char* mask, int maskWidth, int maskHeight,
+                            int numOperaciones, int primerPaso, int numArchivos, int* cadena);
+
+// Catálogo de operaciones candidatas en cada paso de la cadena (como máximo 8 bits a rotar o desplazar):
+// 0 -> XOR con I_M, 1..7 -> rotación a la derecha de 1 a 7 bits,
+// 8..14 -> desplazamiento a la derecha de 1 a 7 bits, 15..21 -> desplazamiento a la izquierda de 1 a 7 bits.
+// La rotación de 8 bits es la identidad y rotar k bits a la izquierda equivale a rotar 8 - k a la derecha,
+// por lo que solo quedan 7 rotaciones distintas. Desplazar 8 bits anula todos los bytes (no queda
+// información que recuperar), así que se excluye. Solo las operaciones 0..7 son invertibles.
+const int NUM_OPERACIONES = 22;
+const int NUM_OPERACIONES_INVERTIBLES = 8;
+// Máxima profundidad de cada expansión (a lo sumo 22^4 estados por nivel si no hay archivos Mk.txt que podar)
+const int PROFUNDIDAD_MAXIMA = 4;
+// Máxima memoria de un nivel de la búsqueda (ventanas, cadenas y tabla hash)
+const long long MAX_BYTES_NIVEL = 1LL << 30;
 
 int main()
 {
@@ -262,6 +304,31 @@ int main()
     delete[] maskingData;
     maskingData = nullptr;
 
+    /*
+    Reconstrucción de la cadena de transformaciones por encuentro a mitad de camino: se expande desde la
+    imagen original (I_O.bmp) y desde el resultado de la cadena (P3.bmp) hasta encontrarse. El enmascaramiento
+    solo se guardó tras las dos primeras operaciones (M1.txt y M2.txt); la última se verifica comparando
+    directamente con P3.bmp. En este caso la cadena esperada es XOR, rotación de 3 bits a la derecha, XOR.
+    */
+    int numeroOperaciones = 3;
+    int numeroArchivosEnmascaramiento = 2;
+    int *cadenaOperaciones = new int[numeroOperaciones];
+
+    if (buscarEncuentroEnMedio(pixelDataimagenOriginal, pixelDataimagenTerceraOperacion, pixelDataimagenAleatoria,
+                               width, height, pixelDataimagenMascara, width_mask, height_mask,
+                               numeroOperaciones, 1, numeroArchivosEnmascaramiento, cadenaOperaciones)) {
+        cout << "Cadena de operaciones encontrada:" << endl;
+        for (int i = 0; i < numeroOperaciones; ++i) {
+            cout << "Paso " << i + 1 << ": ";
+            describirOperacion(cadenaOperaciones[i]);
+        }
+    } else {
+        cout << "No se encontró una cadena de operaciones consistente." << endl;
+    }
+
+    delete[] cadenaOperaciones;
+    cadenaOperaciones = nullptr;
+
 
 
 
@@ -666,3 +733,541 @@ void enmascararYGuardar(unsigned char* imgTransformada, int imgWidth, int imgHei
 
     outFile.close();
 }
+
+bool coincideConEnmascaramiento(unsigned char* datos, unsigned char* mask, unsigned int* valores, int longitud) {
+    /*
+     * @brief Comprueba que datos[i] + mask[i] coincida con los valores de un archivo de enmascaramiento.
+     *
+     * @param datos Puntero al primer byte de la región enmascarada (imagen + semilla, o un bloque de ventana).
+     * @param mask Puntero a la imagen de la máscara (RGB sin padding).
+     * @param valores Valores RGB leídos del archivo Mk.txt (ver loadSeedMasking).
+     * @param longitud Cantidad de bytes a comparar (ancho * alto * 3 de la máscara).
+     * @return true si todos los valores coinciden.
+     */
+
+    for (int i = 0; i < longitud; ++i) {
+        if (datos[i] + mask[i] != valores[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void aplicarOperacionBytes(unsigned char* origen, unsigned char* destino, unsigned char* aleatoria,
+                           int longitud, int op, bool inversa) {
+    /*
+     * @brief Aplica (o deshace, si inversa es true) la operación op del catálogo byte a byte,
+     *        escribiendo el resultado en destino sin reservar memoria.
+     *
+     * El XOR es su propia inversa y la rotación a la derecha se deshace rotando a la izquierda
+     * la misma cantidad de bits. Los desplazamientos pierden información y no tienen inversa,
+     * por lo que con inversa en true solo deben usarse las operaciones 0..7.
+     *
+     * @param aleatoria Bytes de la imagen aleatoria (I_M) alineados con origen, usados por el XOR.
+     * @param longitud Cantidad de bytes a transformar.
+     */
+
+    for (int i = 0; i < longitud; ++i) {
+        if (op == 0) {
+            destino[i] = origen[i] ^ aleatoria[i];
+        } else if (op <= 7) {
+            destino[i] = inversa ? rotateLeft(origen[i], op) : rotateRight(origen[i], op);
+        } else if (op <= 14) {
+            destino[i] = shiftRight(origen[i], op - 7);
+        } else {
+            destino[i] = shiftLeft(origen[i], op - 14);
+        }
+    }
+}
+
+unsigned char* aplicarOperacion(unsigned char* img, unsigned char* imgAleatoria, int width, int height, int op) {
+    /*
+     * @brief Aplica la operación op del catálogo (ver NUM_OPERACIONES) a una imagen.
+     *
+     * @return Puntero a un nuevo arreglo de píxeles; el usuario debe liberarlo con `delete[]`.
+     */
+
+    int dataSize = width * height * 3;
+    unsigned char* result = new unsigned char[dataSize];
+    aplicarOperacionBytes(img, result, imgAleatoria, dataSize, op, false);
+    return result;
+}
+
+void describirOperacion(int op) {
+    // Muestra en consola la operación del catálogo correspondiente a op
+    if (op == 0) {
+        cout << "XOR con la imagen aleatoria" << endl;
+    } else if (op <= 7) {
+        cout << "Rotación de " << op << " bits a la derecha" << endl;
+    } else if (op <= 14) {
+        cout << "Desplazamiento de " << op - 7 << " bits a la derecha" << endl;
+    } else {
+        cout << "Desplazamiento de " << op - 14 << " bits a la izquierda" << endl;
+    }
+}
+
+unsigned long long huellaVentana(unsigned char* img, int inicio, int longitud) {
+    /*
+     * @brief Calcula una huella (hash FNV-1a de 64 bits) de los bytes img[inicio, inicio + longitud).
+     */
+
+    unsigned long long huella = 1469598103934665603ULL;
+    for (int i = 0; i < longitud; ++i) {
+        huella ^= img[inicio + i];
+        huella *= 1099511628211ULL;
+    }
+    return huella;
+}
+
+unsigned char* extraerVentana(unsigned char* img, int* inicios, int numBloques, int longitudBloque) {
+    /*
+     * @brief Copia en un arreglo contiguo los bloques img[inicios[b], inicios[b] + longitudBloque).
+     *
+     * Todas las operaciones del catálogo actúan byte a byte, así que aplicarlas sobre la ventana
+     * equivale a aplicarlas sobre la imagen completa y luego extraer la ventana.
+     *
+     * @return Puntero a un arreglo de numBloques * longitudBloque bytes; liberar con `delete[]`.
+     */
+
+    unsigned char* ventana = new unsigned char[numBloques * longitudBloque];
+    for (int b = 0; b < numBloques; ++b) {
+        memcpy(ventana + b * longitudBloque, img + inicios[b], longitudBloque);
+    }
+    return ventana;
+}
+
+int buscarEnTabla(int* tabla, int capacidad, unsigned char* ventanas, unsigned long long* huellas,
+                  int longitudVentana, unsigned char* ventana, unsigned long long huella) {
+    /*
+     * @brief Busca una ventana en una tabla hash de direccionamiento abierto (sondeo lineal).
+     *
+     * La tabla guarda índices de estados (-1 indica posición libre); ventanas y huellas contienen
+     * los datos de cada estado. La capacidad debe ser potencia de 2.
+     *
+     * @return Posición de la tabla con el estado idéntico a ventana, o la posición libre donde insertarlo.
+     */
+
+    int posicion = (int)(huella & (unsigned long long)(capacidad - 1));
+    while (tabla[posicion] != -1) {
+        int estado = tabla[posicion];
+        if (huellas[estado] == huella &&
+            memcmp(ventanas + estado * longitudVentana, ventana, longitudVentana) == 0) {
+            return posicion;
+        }
+        posicion = (posicion + 1) & (capacidad - 1);
+    }
+    return posicion;
+}
+
+bool reservarNivel(long long maxEstados, long long maxCodigos, int longitudVentana,
+                   unsigned char*& ventanas, unsigned long long*& huellas, int*& primerCodigo,
+                   int*& codigos, int*& siguienteCodigo, int*& tabla, int& capacidad) {
+    /*
+     * @brief Reserva los arreglos de un nivel de la búsqueda para a lo sumo maxEstados ventanas
+     *        y maxCodigos cadenas de operaciones.
+     *
+     * Los tamaños se calculan en long long y se rechazan los niveles que superan MAX_BYTES_NIVEL,
+     * lo que además garantiza que todos los índices quepan en int.
+     *
+     * @param capacidad Parámetro de salida con el tamaño de la tabla hash (potencia de 2).
+     * @return true si se reservó la memoria; false si el nivel es demasiado grande (no se reserva nada).
+     */
+
+    long long capacidadTabla = 1;
+    while (capacidadTabla < 2 * maxEstados) {
+        capacidadTabla <<= 1;
+    }
+
+    long long bytes = maxEstados * (longitudVentana + (long long)sizeof(unsigned long long) + (long long)sizeof(int))
+                    + maxCodigos * 2 * (long long)sizeof(int)
+                    + capacidadTabla * (long long)sizeof(int);
+    if (bytes > MAX_BYTES_NIVEL) {
+        return false;
+    }
+
+    ventanas = new unsigned char[(size_t)(maxEstados * longitudVentana)];
+    huellas = new unsigned long long[(size_t)maxEstados];
+    primerCodigo = new int[(size_t)maxEstados];
+    codigos = new int[(size_t)maxCodigos];
+    siguienteCodigo = new int[(size_t)maxCodigos];
+    tabla = new int[(size_t)capacidadTabla];
+    capacidad = (int)capacidadTabla;
+    return true;
+}
+
+void liberarNivel(unsigned char* ventanas, unsigned long long* huellas, int* primerCodigo,
+                  int* codigos, int* siguienteCodigo, int* tabla) {
+    // Libera los arreglos reservados por reservarNivel (acepta punteros nulos)
+    delete[] ventanas;
+    delete[] huellas;
+    delete[] primerCodigo;
+    delete[] codigos;
+    delete[] siguienteCodigo;
+    delete[] tabla;
+}
+
+int expandirNivel(unsigned char* ventanas, int* primerCodigo, int* codigos, int* siguienteCodigo, int numEstados,
+                  unsigned char* ventanaAleatoria, int longitudVentana, bool inversa,
+                  unsigned char* mask, unsigned int* valoresPaso, int inicioBloque, int longitudBloque,
+                  unsigned char* nuevasVentanas, unsigned long long* nuevasHuellas, int* nuevoPrimerCodigo,
+                  int* nuevosCodigos, int* nuevoSiguienteCodigo, int& numNuevosCodigos,
+                  int* tabla, int capacidad) {
+    /*
+     * @brief Genera el siguiente nivel de la búsqueda aplicando (o deshaciendo) cada operación a cada estado.
+     *
+     * Los estados son ventanas de longitudVentana bytes. Se descartan las que no coinciden con el archivo
+     * Mk.txt del paso generado, y cada ventana distinta se guarda una sola vez. Como dos cadenas pueden dar
+     * la misma ventana y distinta imagen completa, cada estado conserva la lista enlazada de todas las
+     * cadenas que lo generan (primerCodigo -> siguienteCodigo), para verificarlas una por una al unir.
+     *
+     * @param codigos Cadenas de operaciones en base NUM_OPERACIONES; la nueva operación se agrega como
+     *                dígito menos significativo.
+     * @param inversa true para deshacer solo las operaciones invertibles (expansión desde la imagen final).
+     * @param valoresPaso Valores del archivo Mk.txt del paso generado, o nullptr si ese paso no tiene archivo.
+     * @param inicioBloque Posición dentro de la ventana del bloque que corresponde a valoresPaso.
+     * @param nuevasVentanas Arreglos de salida reservados con reservarNivel.
+     * @param numNuevosCodigos Parámetro de salida con la cantidad de cadenas del nuevo nivel.
+     * @return Cantidad de estados (ventanas distintas) del nuevo nivel.
+     */
+
+    for (int i = 0; i < capacidad; ++i) {
+        tabla[i] = -1;
+    }
+
+    int numOperaciones = inversa ? NUM_OPERACIONES_INVERTIBLES : NUM_OPERACIONES;
+    int numNuevos = 0;
+    numNuevosCodigos = 0;
+
+    for (int e = 0; e < numEstados; ++e) {
+        unsigned char* ventana = ventanas + e * longitudVentana;
+        for (int op = 0; op < numOperaciones; ++op) {
+            // Se escribe directamente en la siguiente posición libre; solo se conserva si es válida y nueva
+            unsigned char* siguiente = nuevasVentanas + numNuevos * longitudVentana;
+            aplicarOperacionBytes(ventana, siguiente, ventanaAleatoria, longitudVentana, op, inversa);
+
+            if (valoresPaso != nullptr &&
+                !coincideConEnmascaramiento(siguiente + inicioBloque, mask, valoresPaso, longitudBloque)) {
+                continue;
+            }
+
+            unsigned long long huella = huellaVentana(siguiente, 0, longitudVentana);
+            int posicion = buscarEnTabla(tabla, capacidad, nuevasVentanas, nuevasHuellas,
+                                         longitudVentana, siguiente, huella);
+            int estado = tabla[posicion];
+            if (estado == -1) {
+                estado = numNuevos;
+                nuevasHuellas[estado] = huella;
+                nuevoPrimerCodigo[estado] = -1;
+                tabla[posicion] = estado;
+                numNuevos++;
+            }
+
+            // Agrega al estado todas las cadenas del estado de origen extendidas con op
+            for (int c = primerCodigo[e]; c != -1; c = siguienteCodigo[c]) {
+                nuevosCodigos[numNuevosCodigos] = codigos[c] * NUM_OPERACIONES + op;
+                nuevoSiguienteCodigo[numNuevosCodigos] = nuevoPrimerCodigo[estado];
+                nuevoPrimerCodigo[estado] = numNuevosCodigos;
+                numNuevosCodigos++;
+            }
+        }
+    }
+
+    return numNuevos;
+}
+
+bool verificarCadena(unsigned char* imgInicial, unsigned char* imgFinal, unsigned char* imgAleatoria,
+                     int width, int height, unsigned char* mask, int maskDataSize,
+                     int* semillas, unsigned int* valores, int numArchivos,
+                     int* cadena, int numOperaciones) {
+    /*
+     * @brief Reproduce una cadena de operaciones sobre la imagen completa y la valida paso a paso.
+     *
+     * Tras cada una de las primeras numArchivos operaciones la imagen debe coincidir con el archivo Mk.txt
+     * correspondiente (semillas[k], valores + k * maskDataSize), y el resultado de la última operación
+     * debe ser idéntico a imgFinal.
+     *
+     * @return true si la cadena supera todas las verificaciones.
+     */
+
+    int dataSize = width * height * 3;
+    unsigned char* actual = imgInicial;
+    bool valida = true;
+
+    for (int k = 0; valida && k < numOperaciones; ++k) {
+        unsigned char* siguiente = aplicarOperacion(actual, imgAleatoria, width, height, cadena[k]);
+        if (actual != imgInicial) {
+            delete[] actual;
+        }
+        actual = siguiente;
+
+        if (k < numArchivos) {
+            valida = coincideConEnmascaramiento(actual + semillas[k], mask, valores + k * maskDataSize, maskDataSize);
+        }
+    }
+
+    // La cadena debe reproducir exactamente la imagen final
+    valida = valida && memcmp(actual, imgFinal, dataSize) == 0;
+
+    if (actual != imgInicial) {
+        delete[] actual;
+    }
+    return valida;
+}
+
+bool buscarEncuentroEnMedio(unsigned char* imgInicial, unsigned char* imgFinal, unsigned char* imgAleatoria,
+                            int width, int height, unsigned char* mask, int maskWidth, int maskHeight,
+                            int numOperaciones, int primerPaso, int numArchivos, int* cadena) {
+    /*
+     * @brief Reconstruye la cadena de operaciones que transforma imgInicial en imgFinal mediante una
+     *        búsqueda de encuentro a mitad de camino.
+     *
+     * Una búsqueda directa explora NUM_OPERACIONES^n cadenas. Aquí se expanden por niveles las primeras
+     * operaciones desde imgInicial y las últimas desde imgFinal (deshaciendo solo operaciones invertibles),
+     * y ambas mitades se unen cuando sus ventanas coinciden en la tabla hash del nivel hacia adelante.
+     *
+     * Los estados no son imágenes completas sino la ventana formada por las regiones que cubre la máscara
+     * en cada archivo Mk.txt; cada nivel se poda con el archivo de su paso. Los archivos se leen una sola
+     * vez antes de la búsqueda. Como una misma ventana puede provenir de imágenes completas distintas,
+     * al unir se prueban todas las combinaciones de cadenas de ambos estados con verificarCadena.
+     *
+     * Como los desplazamientos no se pueden deshacer, el punto de encuentro empieza en la mitad de la
+     * cadena y avanza hacia el final reutilizando el nivel anterior; en el último punto la mitad hacia
+     * atrás es la propia imagen final.
+     *
+     * @param imgInicial Imagen original o intermedia conocida desde la que parte la cadena.
+     * @param imgFinal Imagen resultante de aplicar la cadena completa.
+     * @param imgAleatoria Imagen usada en las operaciones XOR (I_M).
+     * @param numOperaciones Longitud de la cadena buscada.
+     * @param primerPaso Número del archivo Mk.txt que verifica la primera operación (1 si se parte de I_O).
+     * @param numArchivos Cantidad de operaciones iniciales con archivo de enmascaramiento
+     *                    (M<primerPaso>.txt .. M<primerPaso + numArchivos - 1>.txt).
+     * @param cadena Arreglo de salida de numOperaciones posiciones con los códigos de operación encontrados.
+     * @return true si se encontró una cadena verificada contra los archivos Mk.txt y la imagen final.
+     */
+
+    if (imgInicial == nullptr || imgFinal == nullptr || imgAleatoria == nullptr || mask == nullptr || cadena == nullptr) {
+        cout << "Error: Una de las imágenes es nula." << endl;
+        return false;
+    }
+
+    if (numOperaciones < 1 || numOperaciones > 2 * PROFUNDIDAD_MAXIMA ||
+        numArchivos < 0 || numArchivos > numOperaciones) {
+        cout << "Error: Cantidad de operaciones fuera de rango." << endl;
+        return false;
+    }
+
+    int imgDataSize = width * height * 3;
+    int maskDataSize = maskWidth * maskHeight * 3;
+
+    if (maskDataSize > imgDataSize) {
+        cout << "Error: La máscara es más grande que la imagen." << endl;
+        return false;
+    }
+
+    // Carga una sola vez la semilla y los valores de cada archivo Mk.txt
+    int numBloques = numArchivos > 0 ? numArchivos : 1;
+    int* semillas = new int[numBloques];
+    unsigned int* valores = new unsigned int[numBloques * maskDataSize];
+    semillas[0] = 0; // Sin archivos, la ventana es el inicio de la imagen
+    bool archivosValidos = true;
+
+    for (int k = 0; archivosValidos && k < numArchivos; ++k) {
+        string archivo = "M" + to_string(primerPaso + k) + ".txt";
+        int n_pixels = 0;
+        unsigned int* maskingData = loadSeedMasking(archivo.c_str(), semillas[k], n_pixels);
+        if (maskingData == nullptr || n_pixels * 3 != maskDataSize ||
+            semillas[k] < 0 || semillas[k] + maskDataSize > imgDataSize) {
+            cout << "Error: El archivo " << archivo << " no corresponde a la máscara y la imagen." << endl;
+            archivosValidos = false;
+        } else {
+            memcpy(valores + k * maskDataSize, maskingData, maskDataSize * sizeof(unsigned int));
+        }
+        delete[] maskingData;
+    }
+
+    if (!archivosValidos) {
+        delete[] semillas;
+        delete[] valores;
+        return false;
+    }
+
+    int longitudVentana = numBloques * maskDataSize;
+    unsigned char* ventanaAleatoria = extraerVentana(imgAleatoria, semillas, numBloques, maskDataSize);
+    bool encontrada = false;
+    bool detenida = false;
+
+    // Niveles hacia atrás: el nivel t contiene la imagen tras la operación numOperaciones - t.
+    // Se construyen una sola vez hasta el punto de encuentro inicial.
+    int puntoInicial = (numOperaciones + 1) / 2;
+    int nivelesAtras = numOperaciones - puntoInicial;
+    unsigned char** ventanasAtras = new unsigned char*[nivelesAtras + 1];
+    unsigned long long** huellasAtras = new unsigned long long*[nivelesAtras + 1];
+    int** primerCodigoAtras = new int*[nivelesAtras + 1];
+    int** codigosAtras = new int*[nivelesAtras + 1];
+    int** siguienteCodigoAtras = new int*[nivelesAtras + 1];
+    int* estadosAtras = new int[nivelesAtras + 1];
+    int* cadenasAtras = new int[nivelesAtras + 1];
+    int nivelesAtrasConstruidos = 0;
+
+    ventanasAtras[0] = extraerVentana(imgFinal, semillas, numBloques, maskDataSize);
+    huellasAtras[0] = new unsigned long long[1];
+    huellasAtras[0][0] = huellaVentana(ventanasAtras[0], 0, longitudVentana);
+    primerCodigoAtras[0] = new int[1];
+    primerCodigoAtras[0][0] = 0;
+    codigosAtras[0] = new int[1];
+    codigosAtras[0][0] = 0;
+    siguienteCodigoAtras[0] = new int[1];
+    siguienteCodigoAtras[0][0] = -1;
+    estadosAtras[0] = 1;
+    cadenasAtras[0] = 1;
+
+    for (int t = 0; !detenida && t < nivelesAtras; ++t) {
+        int* tabla = nullptr;
+        int capacidad = 0;
+        if (!reservarNivel((long long)estadosAtras[t] * NUM_OPERACIONES_INVERTIBLES,
+                           (long long)cadenasAtras[t] * NUM_OPERACIONES_INVERTIBLES, longitudVentana,
+                           ventanasAtras[t + 1], huellasAtras[t + 1], primerCodigoAtras[t + 1],
+                           codigosAtras[t + 1], siguienteCodigoAtras[t + 1], tabla, capacidad)) {
+            detenida = true;
+            break;
+        }
+
+        // Al deshacer una operación se obtiene la imagen del paso anterior, que se poda si tiene archivo
+        int paso = numOperaciones - t - 1;
+        unsigned int* valoresPaso = (paso >= 1 && paso <= numArchivos) ? valores + (paso - 1) * maskDataSize : nullptr;
+
+        estadosAtras[t + 1] = expandirNivel(ventanasAtras[t], primerCodigoAtras[t], codigosAtras[t],
+                                            siguienteCodigoAtras[t], estadosAtras[t],
+                                            ventanaAleatoria, longitudVentana, true,
+                                            mask, valoresPaso, (paso - 1) * maskDataSize, maskDataSize,
+                                            ventanasAtras[t + 1], huellasAtras[t + 1], primerCodigoAtras[t + 1],
+                                            codigosAtras[t + 1], siguienteCodigoAtras[t + 1], cadenasAtras[t + 1],
+                                            tabla, capacidad);
+        delete[] tabla;
+        nivelesAtrasConstruidos++;
+    }
+
+    // Nivel hacia adelante actual (se extiende un nivel por cada avance del punto de encuentro)
+    unsigned char* ventanasAdelante = extraerVentana(imgInicial, semillas, numBloques, maskDataSize);
+    unsigned long long* huellasAdelante = new unsigned long long[1];
+    huellasAdelante[0] = huellaVentana(ventanasAdelante, 0, longitudVentana);
+    int* primerCodigoAdelante = new int[1];
+    primerCodigoAdelante[0] = 0;
+    int* codigosAdelante = new int[1];
+    codigosAdelante[0] = 0;
+    int* siguienteCodigoAdelante = new int[1];
+    siguienteCodigoAdelante[0] = -1;
+    int* tablaAdelante = nullptr;
+    int capacidadAdelante = 0;
+    int estadosAdelante = 1;
+    int cadenasAdelante = 1;
+    int nivelAdelante = 0;
+
+    for (int puntoEncuentro = puntoInicial; !detenida && !encontrada && puntoEncuentro <= numOperaciones; ++puntoEncuentro) {
+        if (puntoEncuentro > PROFUNDIDAD_MAXIMA) {
+            cout << "Búsqueda detenida: la expansión hacia adelante supera la profundidad máxima." << endl;
+            break;
+        }
+
+        while (!detenida && nivelAdelante < puntoEncuentro) {
+            unsigned char* nuevasVentanas = nullptr;
+            unsigned long long* nuevasHuellas = nullptr;
+            int* nuevoPrimerCodigo = nullptr;
+            int* nuevosCodigos = nullptr;
+            int* nuevoSiguienteCodigo = nullptr;
+            int* nuevaTabla = nullptr;
+            int capacidad = 0;
+            if (!reservarNivel((long long)estadosAdelante * NUM_OPERACIONES,
+                               (long long)cadenasAdelante * NUM_OPERACIONES, longitudVentana,
+                               nuevasVentanas, nuevasHuellas, nuevoPrimerCodigo,
+                               nuevosCodigos, nuevoSiguienteCodigo, nuevaTabla, capacidad)) {
+                detenida = true;
+                break;
+            }
+
+            int paso = nivelAdelante + 1;
+            unsigned int* valoresPaso = paso <= numArchivos ? valores + (paso - 1) * maskDataSize : nullptr;
+            int nuevasCadenas = 0;
+
+            estadosAdelante = expandirNivel(ventanasAdelante, primerCodigoAdelante, codigosAdelante,
+                                            siguienteCodigoAdelante, estadosAdelante,
+                                            ventanaAleatoria, longitudVentana, false,
+                                            mask, valoresPaso, (paso - 1) * maskDataSize, maskDataSize,
+                                            nuevasVentanas, nuevasHuellas, nuevoPrimerCodigo,
+                                            nuevosCodigos, nuevoSiguienteCodigo, nuevasCadenas,
+                                            nuevaTabla, capacidad);
+
+            liberarNivel(ventanasAdelante, huellasAdelante, primerCodigoAdelante,
+                         codigosAdelante, siguienteCodigoAdelante, tablaAdelante);
+            ventanasAdelante = nuevasVentanas;
+            huellasAdelante = nuevasHuellas;
+            primerCodigoAdelante = nuevoPrimerCodigo;
+            codigosAdelante = nuevosCodigos;
+            siguienteCodigoAdelante = nuevoSiguienteCodigo;
+            tablaAdelante = nuevaTabla;
+            capacidadAdelante = capacidad;
+            cadenasAdelante = nuevasCadenas;
+            nivelAdelante++;
+        }
+
+        if (detenida) {
+            break;
+        }
+
+        // Une cada estado hacia atrás con el estado de ventana idéntica hacia adelante, si existe,
+        // y verifica cada combinación de sus cadenas sobre la imagen completa
+        int t = numOperaciones - puntoEncuentro;
+        for (int e = 0; !encontrada && e < estadosAtras[t]; ++e) {
+            int posicion = buscarEnTabla(tablaAdelante, capacidadAdelante, ventanasAdelante, huellasAdelante,
+                                         longitudVentana, ventanasAtras[t] + e * longitudVentana, huellasAtras[t][e]);
+            int estado = tablaAdelante[posicion];
+            if (estado == -1) {
+                continue;
+            }
+
+            for (int ca = primerCodigoAdelante[estado]; !encontrada && ca != -1; ca = siguienteCodigoAdelante[ca]) {
+                for (int cb = primerCodigoAtras[t][e]; !encontrada && cb != -1; cb = siguienteCodigoAtras[t][cb]) {
+                    // Decodifica la mitad hacia adelante (operaciones 0 .. puntoEncuentro - 1)
+                    int codigoAdelante = codigosAdelante[ca];
+                    for (int i = puntoEncuentro - 1; i >= 0; --i) {
+                        cadena[i] = codigoAdelante % NUM_OPERACIONES;
+                        codigoAdelante /= NUM_OPERACIONES;
+                    }
+                    // Decodifica la mitad hacia atrás (operaciones puntoEncuentro .. numOperaciones - 1)
+                    int codigoAtras = codigosAtras[t][cb];
+                    for (int i = puntoEncuentro; i < numOperaciones; ++i) {
+                        cadena[i] = codigoAtras % NUM_OPERACIONES;
+                        codigoAtras /= NUM_OPERACIONES;
+                    }
+
+                    encontrada = verificarCadena(imgInicial, imgFinal, imgAleatoria, width, height, mask, maskDataSize,
+                                                 semillas, valores, numArchivos, cadena, numOperaciones);
+                }
+            }
+        }
+    }
+
+    if (detenida) {
+        cout << "Búsqueda detenida: un nivel de la búsqueda supera la memoria máxima." << endl;
+    }
+
+    // Libera la memoria usada por la búsqueda
+    for (int t = 0; t <= nivelesAtrasConstruidos; ++t) {
+        liberarNivel(ventanasAtras[t], huellasAtras[t], primerCodigoAtras[t],
+                     codigosAtras[t], siguienteCodigoAtras[t], nullptr);
+    }
+    delete[] ventanasAtras;
+    delete[] huellasAtras;
+    delete[] primerCodigoAtras;
+    delete[] codigosAtras;
+    delete[] siguienteCodigoAtras;
+    delete[] estadosAtras;
+    delete[] cadenasAtras;
+    liberarNivel(ventanasAdelante, huellasAdelante, primerCodigoAdelante,
+                 codigosAdelante, siguienteCodigoAdelante, tablaAdelante);
+    delete[] ventanaAleatoria;
+    delete[] semillas;
+    delete[] valores;
+
+    return encontrada;
+}